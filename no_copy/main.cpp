@@ -1,3 +1,5 @@
+#include <memory_resource>
+#include <string>
 #include <vector>
 
 #include "no_copy.hpp"
@@ -20,6 +22,17 @@ void test_nc()
     nc_vector<int> cloned_data = nc_data.clone();
 }
 
+void test_nc_clone_with_allocator()
+{
+    using nc_pmr_vector = qc::no_copy<std::pmr::vector<std::pmr::string>>;
+
+    nc_pmr_vector nc_data{"a string too long for the small string optimization"};
+
+    // the vector and its strings are allocated in the arena
+    std::pmr::monotonic_buffer_resource arena;
+    nc_pmr_vector cloned_data = nc_data.clone(&arena);
+}
+
 void test_std_to_nc()
 {
     std::vector<int> data{1, 2, 3, 4};
@@ -34,6 +47,7 @@ void test_std_to_nc()
 int main(int, char**)
 {
     test_nc();
+    test_nc_clone_with_allocator();
     test_std_to_nc();
     return 0;
 }
\ No newline at end of file
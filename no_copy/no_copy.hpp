@@ -2,6 +2,10 @@
 
 #include <utility>
 
+#ifdef QC_NO_COPY_PROFILE
+#include "profile.hpp"
+#endif
+
 namespace qc {
 
 template <typename T>
@@ -10,6 +14,46 @@ public:
     using T::T;
     using T::operator=;
 
+#ifdef QC_NO_COPY_PROFILE
+    no_copy(no_copy&& other,
+            std::source_location location = std::source_location::current()) noexcept(
+        std::is_nothrow_move_constructible_v<T>)
+        : T(std::move(other))
+    {
+        details::record_move<T>(location);
+    }
+    no_copy(T&& other, std::source_location location = std::source_location::current())
+        : T(std::move(other))
+    {
+        details::record_move<T>(location);
+    }
+
+    // operator= can't take the call site, moves assignments are recorded without it
+    no_copy& operator=(no_copy&& other) noexcept(std::is_nothrow_move_assignable_v<T>)
+    {
+        details::record_move<T>({});
+        return static_cast<no_copy&>(T::operator=(std::move(other)));
+    }
+    no_copy& operator=(T&& other)
+    {
+        details::record_move<T>({});
+        return static_cast<no_copy&>(T::operator=(std::move(other)));
+    };
+
+    no_copy clone(std::source_location location = std::source_location::current()) const
+    {
+        details::record_clone<T>(*this, location);
+        return no_copy{*this};
+    }
+
+    template <typename Alloc>
+    no_copy clone(const Alloc& alloc,
+                  std::source_location location = std::source_location::current()) const
+    {
+        details::record_clone<T>(*this, location);
+        return no_copy(static_cast<const T&>(*this), alloc);
+    }
+#else
     no_copy(no_copy&& other) = default;
     no_copy(T&& other) : T(std::move(other)) {}
 
@@ -18,6 +62,16 @@ public:
 
     no_copy clone() const { return no_copy{*this}; }
 
+    // Allocator-extended copy, e.g. clone(&arena) for std::pmr containers.
+    // Nested elements use the allocator only if the container propagates it
+    // (std::pmr containers, std::scoped_allocator_adaptor).
+    template <typename Alloc>
+    no_copy clone(const Alloc& alloc) const
+    {
+        return no_copy(static_cast<const T&>(*this), alloc);
+    }
+#endif
+
 private:
     // don't delete, we need it to clone
     no_copy(const no_copy&) = default;
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <source_location>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+#include <algorithm>
+
+#if __has_include(<cxxabi.h>)
+#include <cxxabi.h>
+#include <cstdlib>
+#endif
+
+// Copy profiling for no_copy, enabled by defining QC_NO_COPY_PROFILE.
+// Every clone() and move is recorded by type and call site,
+// a summary sorted by copied bytes is written to std::cerr at exit.
+
+namespace qc {
+namespace details {
+
+template <typename T, typename = void>
+struct is_range : std::false_type {
+};
+
+template <typename T>
+struct is_range<T,
+                std::void_t<typename T::value_type,
+                            decltype(std::declval<const T&>().begin()),
+                            decltype(std::declval<const T&>().end())>> : std::true_type {
+};
+
+// Bytes copied by a deep copy of value, including the elements of containers
+template <typename T>
+std::size_t deep_size(const T& value)
+{
+    if constexpr (is_range<T>::value) {
+        using value_type = typename T::value_type;
+        std::size_t bytes = sizeof(T);
+        if constexpr (std::is_trivially_copyable_v<value_type>) {
+            bytes += std::distance(value.begin(), value.end()) * sizeof(value_type);
+        }
+        else {
+            for (const auto& element : value) {
+                bytes += deep_size(element);
+            }
+        }
+        return bytes;
+    }
+    else {
+        return sizeof(T);
+    }
+}
+
+class copy_profiler {
+public:
+    static copy_profiler& instance()
+    {
+        static copy_profiler profiler;
+        return profiler;
+    }
+
+    ~copy_profiler() { dump(std::cerr); }
+
+    void record(std::string_view kind,
+                std::string_view type,
+                const std::source_location& location,
+                std::size_t bytes) noexcept
+    {
+        try {
+            std::lock_guard<std::mutex> lock{mutex_};
+            auto& entry = entries_[key{kind,
+                                       type,
+                                       location.file_name(),
+                                       location.line(),
+                                       location.function_name()}];
+            ++entry.count;
+            entry.bytes += bytes;
+        }
+        catch (...) {
+            // profiling must not change the behavior of the program
+        }
+    }
+
+    // Demangled names are allocated once and live until exit
+    std::string_view type_name(const std::type_info& info) noexcept
+    {
+#if __has_include(<cxxabi.h>)
+        try {
+            std::lock_guard<std::mutex> lock{mutex_};
+            auto& name = type_names_[info.name()];
+            if (name.empty()) {
+                int status = 0;
+                char* demangled = abi::__cxa_demangle(info.name(), nullptr, nullptr, &status);
+                name = status == 0 ? demangled : info.name();
+                std::free(demangled);
+            }
+            return name;
+        }
+        catch (...) {
+        }
+#endif
+        return info.name();
+    }
+
+    void dump(std::ostream& os) const
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        if (entries_.empty()) {
+            return;
+        }
+
+        std::vector<std::pair<key, stats>> sorted(entries_.begin(), entries_.end());
+        std::sort(sorted.begin(), sorted.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.second.bytes > rhs.second.bytes;
+        });
+
+        os << "no_copy profile: bytes, count, kind, type, call site" << std::endl;
+        for (const auto& [site, entry] : sorted) {
+            const auto& [kind, type, file, line, function] = site;
+            os << entry.bytes << ", " << entry.count << ", " << kind << ", " << type << ", "
+               << file << ":" << line << " (" << function << ")" << std::endl;
+        }
+    }
+
+private:
+    using key = std::tuple<std::string_view,
+                           std::string_view,
+                           std::string_view,
+                           std::uint_least32_t,
+                           std::string_view>;
+
+    struct stats {
+        std::size_t count = 0;
+        std::size_t bytes = 0;
+    };
+
+    copy_profiler() = default;
+
+    mutable std::mutex mutex_;
+    std::map<key, stats> entries_;
+    std::map<std::string_view, std::string> type_names_;
+};
+
+template <typename T>
+void record_clone(const T& value, const std::source_location& location) noexcept
+{
+    auto& profiler = copy_profiler::instance();
+    profiler.record("clone", profiler.type_name(typeid(T)), location, deep_size(value));
+}
+
+template <typename T>
+void record_move(const std::source_location& location) noexcept
+{
+    auto& profiler = copy_profiler::instance();
+    profiler.record("move", profiler.type_name(typeid(T)), location, sizeof(T));
+}
+
+} // namespace details
+} // namespace qc
@@ -0,0 +1,35 @@
+#include <iostream>
+#include <numeric>
+#include <string>
+
+#include "soa_vector.hpp"
+
+struct S {
+    int a;
+    std::string b;
+    double c;
+};
+
+int main(int, char**)
+{
+    qctools::soa_vector<int, std::string, double> soa;
+    soa.reserve(3);
+    soa.emplace_back(1, "a", 0.5);
+    soa.emplace_back(2, "b", 1.5);
+    soa.push_back({3, "c", 2.5});
+
+    // rows are tuples of references
+    for (auto&& row : soa) {
+        std::get<0>(row) *= 10;
+        std::cerr << std::get<0>(row) << ", " << std::get<1>(row) << ", " << std::get<2>(row)
+                  << std::endl;
+    }
+
+    // scans over a single field only touch its column
+    auto c = soa.column<2>();
+    std::cerr << std::accumulate(c.begin(), c.end(), 0.0) << std::endl;
+
+    auto s = soa.row_as<S>(1);
+    std::cerr << s.a << ", " << s.b << ", " << s.c << std::endl;
+    return 0;
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../to_struct/to_struct.hpp"
+#include "../zip/zip.hpp"
+
+namespace qctools {
+
+// Structure of arrays: each field is stored in its own contiguous column,
+// rows are accessed as tuples of references.
+template <typename... Ts>
+class soa_vector {
+    static_assert(sizeof...(Ts) > 0, "soa_vector needs at least one column");
+    static_assert((!std::is_same_v<Ts, bool> && ...),
+                  "std::vector<bool> is not contiguous, use another type for boolean columns");
+
+    using seq = std::make_index_sequence<sizeof...(Ts)>;
+
+public:
+    using value_type = std::tuple<Ts...>;
+    using reference = std::tuple<Ts&...>;
+    using const_reference = std::tuple<const Ts&...>;
+
+    template <std::size_t I>
+    using column_type = std::tuple_element_t<I, value_type>;
+
+    soa_vector() = default;
+
+    std::size_t size() const { return std::get<0>(columns_).size(); }
+    bool empty() const { return std::get<0>(columns_).empty(); }
+    std::size_t capacity() const { return std::get<0>(columns_).capacity(); }
+
+    void reserve(std::size_t capacity)
+    {
+        std::apply([&](auto&... columns) { (columns.reserve(capacity), ...); }, columns_);
+    }
+
+    void resize(std::size_t size)
+    {
+        grow([&] {
+            std::apply([&](auto&... columns) { (columns.resize(size), ...); }, columns_);
+        });
+    }
+
+    void clear()
+    {
+        std::apply([](auto&... columns) { (columns.clear(), ...); }, columns_);
+    }
+
+    void push_back(const value_type& row) { push_back_impl(row, seq{}); }
+    void push_back(value_type&& row) { push_back_impl(std::move(row), seq{}); }
+
+    // One argument per column
+    template <typename... Args>
+    reference emplace_back(Args&&... args)
+    {
+        static_assert(sizeof...(Args) == sizeof...(Ts), "expected one argument per column");
+        emplace_back_impl(seq{}, std::forward<Args>(args)...);
+        return back();
+    }
+
+    void pop_back()
+    {
+        std::apply([](auto&... columns) { (columns.pop_back(), ...); }, columns_);
+    }
+
+    reference operator[](std::size_t i) { return row_impl<reference>(*this, i, seq{}); }
+    const_reference operator[](std::size_t i) const
+    {
+        return row_impl<const_reference>(*this, i, seq{});
+    }
+
+    reference back() { return (*this)[size() - 1]; }
+    const_reference back() const { return (*this)[size() - 1]; }
+
+    // Build an aggregate from a row, see to_struct
+    template <typename S>
+    S row_as(std::size_t i) const
+    {
+        return to_struct<S>((*this)[i]);
+    }
+
+    template <std::size_t I>
+    std::span<column_type<I>> column()
+    {
+        return std::get<I>(columns_);
+    }
+
+    template <std::size_t I>
+    std::span<const column_type<I>> column() const
+    {
+        return std::get<I>(columns_);
+    }
+
+    auto begin() { return rows().begin(); }
+    auto end() { return rows().end(); }
+    auto begin() const { return rows().begin(); }
+    auto end() const { return rows().end(); }
+
+private:
+    auto rows()
+    {
+        return std::apply([](auto&... columns) { return zip(columns...); }, columns_);
+    }
+
+    auto rows() const
+    {
+        return std::apply([](const auto&... columns) { return zip(columns...); }, columns_);
+    }
+
+    template <typename Row, std::size_t... I>
+    void push_back_impl(Row&& row, std::index_sequence<I...>)
+    {
+        grow([&] {
+            (std::get<I>(columns_).push_back(std::get<I>(std::forward<Row>(row))), ...);
+        });
+    }
+
+    template <std::size_t... I, typename... Args>
+    void emplace_back_impl(std::index_sequence<I...>, Args&&... args)
+    {
+        grow([&] { (std::get<I>(columns_).emplace_back(std::forward<Args>(args)), ...); });
+    }
+
+    // Columns are grown one after the other: if one of them throws,
+    // shrink them all back so that they keep the same length
+    template <typename F>
+    void grow(F&& fct)
+    {
+        const auto old_size = size();
+        try {
+            fct();
+        }
+        catch (...) {
+            std::apply([&](auto&... columns) { (truncate(columns, old_size), ...); }, columns_);
+            throw;
+        }
+    }
+
+    template <typename Column>
+    static void truncate(Column& column, std::size_t size)
+    {
+        while (column.size() > size) {
+            column.pop_back();
+        }
+    }
+
+    template <typename Reference, typename Self, std::size_t... I>
+    static Reference row_impl(Self& self, std::size_t i, std::index_sequence<I...>)
+    {
+        return Reference{std::get<I>(self.columns_)[i]...};
+    }
+
+    std::tuple<std::vector<Ts>...> columns_;
+};
+
+} // namespace qctools
@@ -0,0 +1,259 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "to_tuple.hpp"
+
+// Field-wise hash, equality and ordering for aggregates, usable as
+// std::unordered_map<S, V, qctools::fields_hash, qctools::fields_equal>
+// or std::map<S, V, qctools::fields_less>.
+// Aggregate fields are handled recursively, other fields use std::hash,
+// operator== and operator<, std::array is hashed element by element.
+// Aggregates with their own operator== are compared with it and hashed with
+// std::hash when it is enabled, field by field otherwise: that operator==
+// must then compare the fields, as a defaulted one does.
+
+namespace qctools {
+namespace details {
+
+template <typename T, typename = void>
+struct has_equal : std::false_type {
+};
+
+template <typename T>
+struct has_equal<T, std::void_t<decltype(std::declval<const T&>() == std::declval<const T&>())>>
+    : std::true_type {
+};
+
+template <typename T, typename = void>
+struct has_less : std::false_type {
+};
+
+template <typename T>
+struct has_less<T, std::void_t<decltype(std::declval<const T&>() < std::declval<const T&>())>>
+    : std::true_type {
+};
+
+template <typename T, typename = void>
+struct has_std_hash : std::false_type {
+};
+
+template <typename T>
+struct has_std_hash<
+    T,
+    std::enable_if_t<std::is_default_constructible_v<std::hash<T>> &&
+                     std::is_invocable_r_v<std::size_t, const std::hash<T>&, const T&>>>
+    : std::true_type {
+};
+
+template <typename T>
+constexpr bool use_fields = std::is_aggregate_v<T> && !std::is_array_v<T>;
+
+// Equal values have equal bytes and the other way around
+template <typename T>
+constexpr bool use_bytes =
+    std::has_unique_object_representations_v<T> &&
+    (std::is_scalar_v<T> || is_std_array<T>::value || (use_fields<T> && !has_equal<T>::value));
+
+inline std::uint64_t mix(std::uint64_t h)
+{
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+inline std::uint64_t hash_combine(std::uint64_t seed, std::uint64_t value)
+{
+    return mix(seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2)));
+}
+
+// Hashes bytes 8 at a time
+inline std::uint64_t hash_bytes(std::uint64_t seed, const unsigned char* data, std::size_t size)
+{
+    constexpr std::uint64_t k = 0x9ddfea08eb382d69ULL;
+
+    std::uint64_t h = seed ^ (size * k);
+    for (; size >= 8; data += 8, size -= 8) {
+        std::uint64_t word;
+        std::memcpy(&word, data, 8);
+        h = (h ^ mix(word)) * k;
+    }
+    if (size) {
+        std::uint64_t word = 0;
+        std::memcpy(&word, data, size);
+        h = (h ^ mix(word)) * k;
+    }
+    return mix(h);
+}
+
+template <typename S>
+std::uint64_t hash_fields(std::uint64_t seed, const S& s);
+
+// Walks the fields in order, runs of adjacent fields without padding
+// nor multiple representations are hashed in one pass over their bytes.
+class field_hasher {
+public:
+    explicit field_hasher(std::uint64_t seed) : seed_{seed} {}
+
+    template <typename T>
+    void operator()(const T& field)
+    {
+        if constexpr (use_bytes<T>) {
+            auto first = reinterpret_cast<const unsigned char*>(&field);
+            if (first != run_last_) {
+                flush();
+                run_first_ = first;
+            }
+            run_last_ = first + sizeof(T);
+        }
+        else {
+            flush();
+            seed_ = hash_fields(seed_, field);
+        }
+    }
+
+    std::uint64_t result()
+    {
+        flush();
+        return seed_;
+    }
+
+private:
+    void flush()
+    {
+        if (run_first_) {
+            seed_ = hash_bytes(seed_, run_first_, run_last_ - run_first_);
+            run_first_ = run_last_ = nullptr;
+        }
+    }
+
+    std::uint64_t seed_;
+    const unsigned char* run_first_ = nullptr;
+    const unsigned char* run_last_ = nullptr;
+};
+
+template <typename S>
+std::uint64_t hash_field_list(std::uint64_t seed, const S& s)
+{
+    field_hasher hasher{seed};
+    std::apply([&](const auto&... fields) { (hasher(fields), ...); }, tie_fields(s));
+    return hasher.result();
+}
+
+template <typename S>
+std::uint64_t hash_fields(std::uint64_t seed, const S& s)
+{
+    if constexpr (use_bytes<S>) {
+        return hash_bytes(seed, reinterpret_cast<const unsigned char*>(&s), sizeof(S));
+    }
+    else if constexpr (use_fields<S> && !has_equal<S>::value) {
+        return hash_field_list(seed, s);
+    }
+    else if constexpr (has_std_hash<S>::value) {
+        // operator== decides what equal means, the hash must come with it
+        return hash_combine(seed, std::hash<S>{}(s));
+    }
+    else if constexpr (is_std_array<S>::value) {
+        for (const auto& element : s) {
+            seed = hash_fields(seed, element);
+        }
+        return seed;
+    }
+    else {
+        static_assert(use_fields<S>, "type needs a std::hash specialization");
+        return hash_field_list(seed, s);
+    }
+}
+
+template <typename T>
+bool equal_fields(const T& lhs, const T& rhs)
+{
+    if constexpr (use_bytes<T>) {
+        return std::memcmp(&lhs, &rhs, sizeof(T)) == 0;
+    }
+    else if constexpr (use_fields<T> && !has_equal<T>::value) {
+        return std::apply(
+            [&](const auto&... lhs_fields) {
+                return std::apply(
+                    [&](const auto&... rhs_fields) {
+                        return (equal_fields(lhs_fields, rhs_fields) && ...);
+                    },
+                    tie_fields(rhs));
+            },
+            tie_fields(lhs));
+    }
+    else {
+        return lhs == rhs;
+    }
+}
+
+template <typename T>
+bool less_fields(const T& lhs, const T& rhs);
+
+template <typename L, typename R, std::size_t... I>
+bool less_tuples(const L& lhs, const R& rhs, std::index_sequence<I...>)
+{
+    // lexicographical comparison: stop at the first field that differs
+    bool result = false;
+    bool done = false;
+    auto compare = [&](const auto& l, const auto& r) {
+        if (less_fields(l, r)) {
+            result = true;
+            done = true;
+        }
+        else if (less_fields(r, l)) {
+            done = true;
+        }
+    };
+    ((done ? void() : compare(std::get<I>(lhs), std::get<I>(rhs))), ...);
+    return result;
+}
+
+template <typename T>
+bool less_fields(const T& lhs, const T& rhs)
+{
+    if constexpr (use_fields<T> && !has_less<T>::value) {
+        return less_tuples(
+            tie_fields(lhs), tie_fields(rhs), std::make_index_sequence<field_count<T>>{});
+    }
+    else {
+        return lhs < rhs;
+    }
+}
+
+} // namespace details
+
+struct fields_hash {
+    template <typename S>
+    std::size_t operator()(const S& s) const
+    {
+        return static_cast<std::size_t>(details::hash_fields(0, s));
+    }
+};
+
+struct fields_equal {
+    template <typename S>
+    bool operator()(const S& lhs, const S& rhs) const
+    {
+        return details::equal_fields(lhs, rhs);
+    }
+};
+
+struct fields_less {
+    template <typename S>
+    bool operator()(const S& lhs, const S& rhs) const
+    {
+        return details::less_fields(lhs, rhs);
+    }
+};
+
+} // namespace qctools
@@ -0,0 +1,109 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "hash.hpp"
+
+struct Key {
+    std::uint32_t a;
+    std::uint32_t b;
+    std::uint64_t c;
+    std::uint64_t d;
+};
+
+struct NamedKey {
+    std::uint32_t a;
+    std::uint32_t b;
+    std::uint64_t c;
+    std::string name;
+};
+
+// What we usually write by hand
+template <typename T>
+void combine(std::size_t& seed, const T& value)
+{
+    seed ^= std::hash<T>{}(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+struct hand_hash {
+    std::size_t operator()(const Key& k) const
+    {
+        std::size_t seed = 0;
+        combine(seed, k.a);
+        combine(seed, k.b);
+        combine(seed, k.c);
+        combine(seed, k.d);
+        return seed;
+    }
+
+    std::size_t operator()(const NamedKey& k) const
+    {
+        std::size_t seed = 0;
+        combine(seed, k.a);
+        combine(seed, k.b);
+        combine(seed, k.c);
+        combine(seed, k.name);
+        return seed;
+    }
+};
+
+struct hand_equal {
+    bool operator()(const Key& l, const Key& r) const
+    {
+        return l.a == r.a && l.b == r.b && l.c == r.c && l.d == r.d;
+    }
+
+    bool operator()(const NamedKey& l, const NamedKey& r) const
+    {
+        return l.a == r.a && l.b == r.b && l.c == r.c && l.name == r.name;
+    }
+};
+
+template <typename Hash, typename Equal, typename T>
+void bench(const std::string& name, const std::vector<T>& keys)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    std::unordered_set<T, Hash, Equal> set;
+    set.reserve(keys.size());
+    for (const auto& key : keys) {
+        set.insert(key);
+    }
+    std::size_t found = 0;
+    for (int i = 0; i < 4; ++i) {
+        for (const auto& key : keys) {
+            found += set.count(key);
+        }
+    }
+
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+    std::cout << name << ": " << ms << "ms, " << set.size() << " distinct keys, "
+              << set.bucket_count() << " buckets, " << found << " found" << std::endl;
+}
+
+int main(int, char**)
+{
+    constexpr std::uint32_t size = 1'000'000;
+
+    // low entropy keys, which is where weak combiners collide
+    std::vector<Key> keys;
+    std::vector<NamedKey> named_keys;
+    keys.reserve(size);
+    named_keys.reserve(size);
+    for (std::uint32_t i = 0; i < size; ++i) {
+        keys.push_back(Key{i % 1000, i / 1000, i % 7, 0});
+        named_keys.push_back(NamedKey{i % 1000, i / 1000, i % 7, "key"});
+    }
+
+    bench<hand_hash, hand_equal>("hand-written, trivially copyable", keys);
+    bench<qctools::fields_hash, qctools::fields_equal>("fields, trivially copyable", keys);
+    bench<hand_hash, hand_equal>("hand-written, with string", named_keys);
+    bench<qctools::fields_hash, qctools::fields_equal>("fields, with string", named_keys);
+    return 0;
+}
@@ -1,7 +1,14 @@
+#include <array>
+#include <cstdint>
 #include <string>
 #include <tuple>
+#include <vector>
 
+#include "hash.hpp"
+#include "serialize.hpp"
 #include "to_struct.hpp"
+#include "to_tuple.hpp"
+#include "transpose.hpp"
 
 struct S {
     int a;
@@ -9,9 +16,45 @@ struct S {
     double c;
 };
 
+struct Point {
+    double x;
+    double y;
+};
+
+struct Uuid {
+    std::array<std::uint8_t, 16> bytes;
+    std::string name;
+};
+
 int main(int, char**)
 {
     auto tup = std::make_tuple(1, "toto", 2.0);
     auto s = qctools::to_struct<S>(tup);
-    return 0;
+
+    auto fields = qctools::to_tuple(s);
+    auto s2 = qctools::to_struct<S>(fields);
+
+    // field-wise encoding
+    auto buffer = qctools::serialize(std::vector<S>{s, s2});
+    auto structs = qctools::deserialize<std::vector<S>>(buffer);
+
+    // trivially copyable elements are copied at once
+    auto points_buffer = qctools::serialize(std::vector<Point>(1000, Point{1.0, 2.0}));
+    auto points = qctools::deserialize<std::vector<Point>>(points_buffer);
+
+    // array of structures to structure of arrays and back
+    auto columns = qctools::to_columns(std::move(structs));
+    auto rows = qctools::to_structs<S>(std::move(columns));
+
+    // generated hash and comparisons
+    bool same = qctools::fields_equal{}(s, s2) && !qctools::fields_less{}(s, s2) &&
+                qctools::fields_hash{}(s) == qctools::fields_hash{}(s2);
+
+    // std::array fields have no std::hash, they are hashed element by element
+    Uuid id{{1, 2, 3, 4}, "id"};
+    Uuid id2 = id;
+    same = same && qctools::fields_equal{}(id, id2) &&
+           qctools::fields_hash{}(id) == qctools::fields_hash{}(id2);
+
+    return same && rows.size() == 2 && rows[1].b == "toto" && points.size() == 1000 ? 0 : 1;
 }
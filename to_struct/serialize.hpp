@@ -0,0 +1,294 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "to_struct.hpp"
+#include "to_tuple.hpp"
+
+// Binary serialization in native byte order:
+// - trivially copyable values whose bytes are exactly their content, without
+//   padding nor pointers, and floating point values are copied as is,
+// - contiguous containers of such types (std::vector, std::string)
+//   are a 64 bits size followed by a single copy of the elements,
+// - other containers are a 64 bits size followed by each element,
+//   std::array has no size,
+// - other aggregates are their fields, one after the other, so that padding
+//   bytes are never written.
+// Pointers, and aggregates holding them without being containers, can't be
+// serialized. Pointers hidden in the private members of trivially copyable
+// classes can't be detected, such classes are copied as is.
+
+namespace qctools {
+namespace details {
+
+template <typename T, typename = void>
+struct is_range : std::false_type {
+};
+
+template <typename T>
+struct is_range<T,
+                std::void_t<typename T::value_type,
+                            decltype(std::declval<T&>().begin()),
+                            decltype(std::declval<T&>().end())>> : std::true_type {
+};
+
+template <typename T>
+constexpr bool is_memcpy_safe();
+
+// Converts to the field types that can be copied as is, see is_brace_constructible.
+// The other conversions are deleted rather than removed, so that brace elision
+// does not spread an initializer over the fields of an aggregate member.
+struct memcpy_safe_field {
+    template <typename T, std::enable_if_t<is_memcpy_safe<T>(), int> = 0>
+    constexpr operator T&() const noexcept;
+
+    template <typename T, std::enable_if_t<!is_memcpy_safe<T>(), int> = 0>
+    operator T&() const = delete;
+};
+
+template <std::size_t>
+using memcpy_safe_field_t = memcpy_safe_field;
+
+template <typename S, typename Seq = std::make_index_sequence<field_count<S>>, typename = void>
+struct has_memcpy_safe_fields : std::false_type {
+};
+
+template <typename S, std::size_t... I>
+struct has_memcpy_safe_fields<S,
+                              std::index_sequence<I...>,
+                              std::void_t<decltype(S{memcpy_safe_field_t<I>{}...})>>
+    : std::true_type {
+};
+
+template <typename T, typename Fields, std::size_t... I>
+constexpr bool are_fields_memcpy_safe(std::index_sequence<I...>)
+{
+    using field_types = std::tuple<std::decay_t<std::tuple_element_t<I, Fields>>...>;
+    return (is_memcpy_safe<std::tuple_element_t<I, field_types>>() && ...) &&
+           (sizeof(std::tuple_element_t<I, field_types>) + ...) == sizeof(T);
+}
+
+// Values whose bytes are exactly their content: no pointers and no padding
+template <typename T>
+constexpr bool is_memcpy_safe()
+{
+    if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>) {
+        return true;
+    }
+    else if constexpr (std::is_array_v<T>) {
+        return is_memcpy_safe<std::remove_extent_t<T>>();
+    }
+    else if constexpr (is_std_array<T>::value) {
+        return is_memcpy_safe<typename T::value_type>() &&
+               sizeof(T) == std::tuple_size<T>::value * sizeof(typename T::value_type);
+    }
+    else if constexpr (!std::is_trivially_copyable_v<T> ||
+                       !(std::is_class_v<T> || std::is_union_v<T>) || is_range<T>::value) {
+        return false;
+    }
+    else if constexpr (std::has_unique_object_representations_v<T>) {
+        // no padding, only aggregates can be searched for pointers
+        if constexpr (std::is_aggregate_v<T> && std::is_class_v<T>) {
+            return has_memcpy_safe_fields<T>::value;
+        }
+        else {
+            return true;
+        }
+    }
+    else if constexpr (std::is_aggregate_v<T> && !has_c_array_fields<T>) {
+        // floating point fields have several representations, look for padding
+        using fields = decltype(tie_fields(std::declval<T&>()));
+        return are_fields_memcpy_safe<T, fields>(std::make_index_sequence<field_count<T>>{});
+    }
+    else {
+        return false;
+    }
+}
+
+template <typename T, typename = void>
+struct is_contiguous : std::false_type {
+};
+
+template <typename T>
+struct is_contiguous<T,
+                     std::void_t<decltype(std::declval<T&>().data()),
+                                 decltype(std::declval<T&>().resize(std::size_t{}))>>
+    : std::bool_constant<is_memcpy_safe<typename T::value_type>()> {
+};
+
+inline void write_bytes(std::vector<char>& buffer, const void* data, std::size_t size)
+{
+    auto bytes = static_cast<const char*>(data);
+    buffer.insert(buffer.end(), bytes, bytes + size);
+}
+
+inline void read_bytes(const char*& first, const char* last, void* data, std::size_t size)
+{
+    if (static_cast<std::size_t>(last - first) < size) {
+        throw std::out_of_range("not enough data to deserialize");
+    }
+    std::memcpy(data, first, size);
+    first += size;
+}
+
+template <typename T>
+void serialize_impl(std::vector<char>& buffer, const T& value);
+
+template <typename T>
+T deserialize_impl(const char*& first, const char* last);
+
+template <typename Tuple, std::size_t... I>
+void serialize_fields(std::vector<char>& buffer, const Tuple& fields, std::index_sequence<I...>)
+{
+    (serialize_impl(buffer, std::get<I>(fields)), ...);
+}
+
+template <typename S, typename Tuple, std::size_t... I>
+S deserialize_fields(const char*& first, const char* last, std::index_sequence<I...>)
+{
+    // braced initialization evaluates fields from left to right
+    return to_struct<S>(std::tuple<std::decay_t<std::tuple_element_t<I, Tuple>>...>{
+        deserialize_impl<std::decay_t<std::tuple_element_t<I, Tuple>>>(first, last)...});
+}
+
+template <typename T>
+void serialize_impl(std::vector<char>& buffer, const T& value)
+{
+    if constexpr (is_memcpy_safe<T>()) {
+        write_bytes(buffer, &value, sizeof(T));
+    }
+    else if constexpr (is_std_array<T>::value) {
+        for (const auto& element : value) {
+            serialize_impl(buffer, element);
+        }
+    }
+    else if constexpr (is_range<T>::value) {
+        const std::uint64_t size = std::distance(value.begin(), value.end());
+        write_bytes(buffer, &size, sizeof(size));
+        if constexpr (is_contiguous<T>::value) {
+            write_bytes(buffer, value.data(), size * sizeof(typename T::value_type));
+        }
+        else {
+            for (const auto& element : value) {
+                serialize_impl(buffer, element);
+            }
+        }
+    }
+    else if constexpr (std::is_pointer_v<T> || std::is_member_pointer_v<T>) {
+        static_assert(!std::is_pointer_v<T> && !std::is_member_pointer_v<T>,
+                      "pointers can't be serialized");
+    }
+    else if constexpr (!std::is_aggregate_v<T>) {
+        static_assert(std::is_aggregate_v<T>,
+                      "type can't be serialized: it can't be copied as is "
+                      "and is neither a container nor an aggregate");
+    }
+    else if constexpr (has_c_array_fields<T>) {
+        static_assert(!has_c_array_fields<T>,
+                      "aggregates with C array members can only be serialized when they "
+                      "are copied as is, without padding nor pointers");
+    }
+    else {
+        auto fields = tie_fields(value);
+        serialize_fields(buffer, fields, std::make_index_sequence<field_count<T>>{});
+    }
+}
+
+template <typename T>
+T deserialize_impl(const char*& first, const char* last)
+{
+    if constexpr (is_memcpy_safe<T>()) {
+        T value;
+        read_bytes(first, last, &value, sizeof(T));
+        return value;
+    }
+    else if constexpr (is_std_array<T>::value) {
+        T value;
+        for (auto& element : value) {
+            element = deserialize_impl<typename T::value_type>(first, last);
+        }
+        return value;
+    }
+    else if constexpr (is_range<T>::value) {
+        using value_type = typename T::value_type;
+
+        std::uint64_t size;
+        read_bytes(first, last, &size, sizeof(size));
+
+        T value;
+        if constexpr (is_contiguous<T>::value) {
+            if (static_cast<std::uint64_t>(last - first) / sizeof(value_type) < size) {
+                throw std::out_of_range("not enough data to deserialize");
+            }
+            value.resize(size);
+            read_bytes(first, last, value.data(), size * sizeof(value_type));
+        }
+        else {
+            for (std::uint64_t i = 0; i < size; ++i) {
+                value.insert(value.end(), deserialize_impl<value_type>(first, last));
+            }
+        }
+        return value;
+    }
+    else if constexpr (std::is_pointer_v<T> || std::is_member_pointer_v<T>) {
+        static_assert(!std::is_pointer_v<T> && !std::is_member_pointer_v<T>,
+                      "pointers can't be deserialized");
+    }
+    else if constexpr (!std::is_aggregate_v<T>) {
+        static_assert(std::is_aggregate_v<T>,
+                      "type can't be deserialized: it can't be copied as is "
+                      "and is neither a container nor an aggregate");
+    }
+    else if constexpr (has_c_array_fields<T>) {
+        static_assert(!has_c_array_fields<T>,
+                      "aggregates with C array members can only be deserialized when they "
+                      "are copied as is, without padding nor pointers");
+    }
+    else {
+        using fields = decltype(tie_fields(std::declval<T&>()));
+        return deserialize_fields<T, fields>(
+            first, last, std::make_index_sequence<field_count<T>>{});
+    }
+}
+
+} // namespace details
+
+// Appends the binary representation of value to buffer
+template <typename T>
+void serialize(std::vector<char>& buffer, const T& value)
+{
+    details::serialize_impl(buffer, value);
+}
+
+template <typename T>
+std::vector<char> serialize(const T& value)
+{
+    std::vector<char> buffer;
+    serialize(buffer, value);
+    return buffer;
+}
+
+// Reads a T from [first, last) and moves first past it,
+// throws std::out_of_range if the data is truncated.
+template <typename T>
+T deserialize(const char*& first, const char* last)
+{
+    return details::deserialize_impl<T>(first, last);
+}
+
+template <typename T>
+T deserialize(const std::vector<char>& buffer)
+{
+    const char* first = buffer.data();
+    return deserialize<T>(first, buffer.data() + buffer.size());
+}
+
+} // namespace qctools
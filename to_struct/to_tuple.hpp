@@ -0,0 +1,208 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace qctools {
+namespace details {
+
+struct any_field {
+    template <typename T>
+    constexpr operator T&() const noexcept;
+};
+
+template <std::size_t>
+using any_field_t = any_field;
+
+template <typename S, typename Seq, typename = void>
+struct is_brace_constructible : std::false_type {
+};
+
+template <typename S, std::size_t... I>
+struct is_brace_constructible<S,
+                              std::index_sequence<I...>,
+                              std::void_t<decltype(S{any_field_t<I>{}...})>> : std::true_type {
+};
+
+template <typename S, std::size_t N, typename = void>
+struct field_count_impl : std::integral_constant<std::size_t, N> {
+};
+
+template <typename S, std::size_t N>
+struct field_count_impl<
+    S,
+    N,
+    std::enable_if_t<is_brace_constructible<S, std::make_index_sequence<N + 1>>::value>>
+    : field_count_impl<S, N + 1> {
+};
+
+// A braced list initializes a whole member, but C array members take one
+// initializer per element through brace elision: a braced list at the first
+// position of such a member leaves too few members for the other initializers.
+template <typename S, typename Before, typename After, typename = void>
+struct takes_empty_braces : std::false_type {
+};
+
+template <typename S, std::size_t... I, std::size_t... J>
+struct takes_empty_braces<S,
+                          std::index_sequence<I...>,
+                          std::index_sequence<J...>,
+                          std::void_t<decltype(S{any_field_t<I>{}..., {}, any_field_t<J>{}...})>>
+    : std::true_type {
+};
+
+// Same for members that can't be value initialized, such as references
+template <typename S, typename Before, typename After, typename = void>
+struct takes_braced_field : std::false_type {
+};
+
+template <typename S, std::size_t... I, std::size_t... J>
+struct takes_braced_field<
+    S,
+    std::index_sequence<I...>,
+    std::index_sequence<J...>,
+    std::void_t<decltype(S{any_field_t<I>{}..., {any_field{}}, any_field_t<J>{}...})>>
+    : std::true_type {
+};
+
+template <typename S, std::size_t... K>
+constexpr bool has_c_array_fields_impl(std::index_sequence<K...>)
+{
+    constexpr auto count = sizeof...(K);
+    return !((takes_empty_braces<S,
+                                 std::make_index_sequence<K>,
+                                 std::make_index_sequence<count - K - 1>>::value ||
+              takes_braced_field<S,
+                                 std::make_index_sequence<K>,
+                                 std::make_index_sequence<count - K - 1>>::value) &&
+             ...);
+}
+
+template <typename S>
+constexpr bool has_c_array_fields =
+    has_c_array_fields_impl<S>(std::make_index_sequence<field_count_impl<S, 0>::value>{});
+
+template <typename T>
+struct is_std_array : std::false_type {
+};
+
+template <typename T, std::size_t N>
+struct is_std_array<std::array<T, N>> : std::true_type {
+};
+
+template <typename Tuple, std::size_t... I>
+auto move_fields(Tuple&& refs, std::index_sequence<I...>)
+{
+    return std::tuple<std::decay_t<std::tuple_element_t<I, std::decay_t<Tuple>>>...>{
+        std::move(std::get<I>(refs))...};
+}
+
+template <typename Tuple, std::size_t... I>
+auto copy_fields(Tuple&& refs, std::index_sequence<I...>)
+{
+    return std::tuple<std::decay_t<std::tuple_element_t<I, std::decay_t<Tuple>>>...>{
+        std::get<I>(refs)...};
+}
+
+} // namespace details
+
+// Number of fields of an aggregate. Members that are themselves aggregates count
+// as one field, but C arrays members are not supported.
+template <typename S>
+constexpr std::size_t field_count = details::field_count_impl<std::remove_cv_t<S>, 0>::value;
+
+// Inverse of to_struct: tuple of references to the fields of an aggregate
+template <typename S>
+auto tie_fields(S& s)
+{
+    static_assert(std::is_aggregate_v<std::remove_cv_t<S>>, "tie_fields needs an aggregate");
+
+    constexpr auto count = field_count<S>;
+    static_assert(count > 0 && count <= 16, "unsupported number of fields");
+    static_assert(!details::has_c_array_fields<std::remove_cv_t<S>>,
+                  "C array members are not supported");
+
+    if constexpr (count == 1) {
+        auto& [f0] = s;
+        return std::tie(f0);
+    }
+    else if constexpr (count == 2) {
+        auto& [f0, f1] = s;
+        return std::tie(f0, f1);
+    }
+    else if constexpr (count == 3) {
+        auto& [f0, f1, f2] = s;
+        return std::tie(f0, f1, f2);
+    }
+    else if constexpr (count == 4) {
+        auto& [f0, f1, f2, f3] = s;
+        return std::tie(f0, f1, f2, f3);
+    }
+    else if constexpr (count == 5) {
+        auto& [f0, f1, f2, f3, f4] = s;
+        return std::tie(f0, f1, f2, f3, f4);
+    }
+    else if constexpr (count == 6) {
+        auto& [f0, f1, f2, f3, f4, f5] = s;
+        return std::tie(f0, f1, f2, f3, f4, f5);
+    }
+    else if constexpr (count == 7) {
+        auto& [f0, f1, f2, f3, f4, f5, f6] = s;
+        return std::tie(f0, f1, f2, f3, f4, f5, f6);
+    }
+    else if constexpr (count == 8) {
+        auto& [f0, f1, f2, f3, f4, f5, f6, f7] = s;
+        return std::tie(f0, f1, f2, f3, f4, f5, f6, f7);
+    }
+    else if constexpr (count == 9) {
+        auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8] = s;
+        return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8);
+    }
+    else if constexpr (count == 10) {
+        auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9] = s;
+        return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9);
+    }
+    else if constexpr (count == 11) {
+        auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10] = s;
+        return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10);
+    }
+    else if constexpr (count == 12) {
+        auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11] = s;
+        return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11);
+    }
+    else if constexpr (count == 13) {
+        auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12] = s;
+        return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12);
+    }
+    else if constexpr (count == 14) {
+        auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13] = s;
+        return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13);
+    }
+    else if constexpr (count == 15) {
+        auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14] = s;
+        return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14);
+    }
+    else if constexpr (count == 16) {
+        auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15] = s;
+        return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15);
+    }
+}
+
+// Inverse of to_struct: tuple of the values of the fields of an aggregate,
+// fields are moved out of rvalues
+template <typename S>
+auto to_tuple(S&& s)
+{
+    constexpr auto count = field_count<std::remove_reference_t<S>>;
+    if constexpr (std::is_lvalue_reference_v<S>) {
+        return details::copy_fields(tie_fields(s), std::make_index_sequence<count>{});
+    }
+    else {
+        return details::move_fields(tie_fields(s), std::make_index_sequence<count>{});
+    }
+}
+
+} // namespace qctools
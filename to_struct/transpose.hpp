@@ -0,0 +1,100 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "to_struct.hpp"
+#include "to_tuple.hpp"
+
+// Bulk conversions between an array of structures and a tuple of columns.
+// Elements are moved out of rvalue inputs and copied from lvalue inputs.
+
+namespace qctools {
+namespace details {
+
+// Rows converted at once when filling columns, sized to stay in the L1 cache
+constexpr std::size_t transpose_block_bytes = 32 * 1024;
+
+// Moves element if its container was given as an rvalue
+template <typename Container, typename T>
+decltype(auto) forward_element(T& element)
+{
+    if constexpr (std::is_lvalue_reference_v<Container>) {
+        return static_cast<const T&>(element);
+    }
+    else {
+        return std::move(element);
+    }
+}
+
+template <typename S, typename Columns, std::size_t... I>
+std::vector<S> to_structs(Columns&& columns, std::index_sequence<I...>)
+{
+    const std::size_t size = std::min({std::size_t(std::get<I>(columns).size())...});
+
+    std::vector<S> structs;
+    structs.reserve(size);
+    for (std::size_t row = 0; row < size; ++row) {
+        structs.push_back(to_struct<S>(std::forward_as_tuple(
+            forward_element<decltype(std::get<I>(std::forward<Columns>(columns)))>(
+                std::get<I>(columns)[row])...)));
+    }
+    return structs;
+}
+
+template <std::size_t I, typename Structs, typename Column>
+void fill_column(std::remove_reference_t<Structs>& structs,
+                 Column& column,
+                 std::size_t first,
+                 std::size_t last)
+{
+    for (std::size_t row = first; row < last; ++row) {
+        column.push_back(forward_element<Structs>(std::get<I>(tie_fields(structs[row]))));
+    }
+}
+
+template <typename Structs, std::size_t... I>
+auto to_columns(Structs&& structs, std::index_sequence<I...>)
+{
+    using S = typename std::decay_t<Structs>::value_type;
+    using fields = decltype(tie_fields(std::declval<S&>()));
+
+    std::tuple<std::vector<std::decay_t<std::tuple_element_t<I, fields>>>...> columns;
+    (std::get<I>(columns).reserve(structs.size()), ...);
+
+    // fill the columns one block of rows at a time, so that each column
+    // is written sequentially while the block stays in cache
+    constexpr std::size_t block = std::max<std::size_t>(1, transpose_block_bytes / sizeof(S));
+    for (std::size_t first = 0; first < structs.size(); first += block) {
+        const auto last = std::min(structs.size(), first + block);
+        (fill_column<I, Structs>(structs, std::get<I>(columns), first, last), ...);
+    }
+    return columns;
+}
+
+} // namespace details
+
+// Tuple of columns (containers with size() and operator[]) to a vector of S,
+// the shortest column gives the number of rows.
+template <typename S, typename Columns>
+std::vector<S> to_structs(Columns&& columns)
+{
+    return details::to_structs<S>(
+        std::forward<Columns>(columns),
+        std::make_index_sequence<std::tuple_size<std::decay_t<Columns>>{}>{});
+}
+
+// Vector of aggregates to a tuple of one std::vector per field
+template <typename Structs>
+auto to_columns(Structs&& structs)
+{
+    using S = typename std::decay_t<Structs>::value_type;
+    return details::to_columns(std::forward<Structs>(structs),
+                               std::make_index_sequence<field_count<S>>{});
+}
+
+} // namespace qctools
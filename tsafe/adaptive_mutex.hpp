@@ -0,0 +1,108 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <algorithm>
+
+namespace qc {
+
+namespace details {
+inline void cpu_relax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#else
+    std::this_thread::yield();
+#endif
+}
+} // namespace details
+
+// Mutex that spins with exponential backoff before sleeping.
+// The spin budget follows how long lockers recently had to spin before
+// getting the lock, which tracks the hold time of the critical sections:
+// short sections are waited for by spinning, long ones quickly park the thread.
+// Usable as the Mutex of tsafe and waitable_tsafe (with std::condition_variable_any).
+class adaptive_mutex {
+public:
+    static constexpr int min_spins = 16;
+    static constexpr int max_spins = 4096;
+    static constexpr int max_backoff = 64;
+
+    adaptive_mutex() = default;
+    adaptive_mutex(const adaptive_mutex&) = delete;
+    adaptive_mutex& operator=(const adaptive_mutex&) = delete;
+
+    void lock()
+    {
+        if (try_lock()) {
+            return;
+        }
+        if (spin()) {
+            return;
+        }
+        park();
+    }
+
+    bool try_lock()
+    {
+        int expected = unlocked;
+        return state_.compare_exchange_strong(
+            expected, locked, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    void unlock()
+    {
+        if (state_.exchange(unlocked, std::memory_order_release) == contended) {
+            std::lock_guard<std::mutex> lock{park_mutex_};
+            park_cv_.notify_one();
+        }
+    }
+
+private:
+    enum state : int { unlocked, locked, contended };
+
+    bool spin()
+    {
+        const int estimate = spin_estimate_.load(std::memory_order_relaxed);
+        const int budget = std::min(max_spins, 2 * estimate + min_spins);
+
+        int spins = 0;
+        for (int backoff = 1; spins < budget; backoff = std::min(2 * backoff, max_backoff)) {
+            for (int i = 0; i < backoff; ++i) {
+                details::cpu_relax();
+            }
+            spins += backoff;
+
+            if (state_.load(std::memory_order_relaxed) == unlocked && try_lock()) {
+                // move the estimate 1/8th of the way toward what was needed
+                spin_estimate_.store(estimate + (spins - estimate) / 8,
+                                     std::memory_order_relaxed);
+                return true;
+            }
+        }
+
+        // spinning was not worth it, spin less next time
+        spin_estimate_.store(estimate - estimate / 8, std::memory_order_relaxed);
+        return false;
+    }
+
+    void park()
+    {
+        std::unique_lock<std::mutex> lock{park_mutex_};
+        // leave the state to contended so that unlock wakes the other sleepers
+        while (state_.exchange(contended, std::memory_order_acquire) != unlocked) {
+            park_cv_.wait(lock);
+        }
+    }
+
+    std::atomic<int> state_{unlocked};
+    std::atomic<int> spin_estimate_{0};
+    std::mutex park_mutex_;
+    std::condition_variable park_cv_;
+};
+
+} // namespace qc
@@ -0,0 +1,54 @@
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "adaptive_mutex.hpp"
+#include "tsafe.hpp"
+
+using namespace qc;
+
+namespace {
+
+constexpr int total_writes = 4'000'000;
+
+// Short critical sections, the case where sleeping costs more than waiting
+template <typename TSafe>
+void bench(const std::string& name, unsigned thread_count)
+{
+    TSafe safe{0};
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i < thread_count; ++i) {
+        threads.emplace_back([&] {
+            for (int j = 0; j < total_writes / static_cast<int>(thread_count); ++j) {
+                safe.write([](auto& v) { ++v; });
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+
+    std::cout << name << ", " << thread_count << " threads: " << ms << "ms (" << safe.get()
+              << " writes)" << std::endl;
+}
+
+} // namespace
+
+int main(int, char**)
+{
+    const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+
+    // up to 4 threads per core to measure oversubscription
+    for (unsigned threads : {1u, 2u, 4u, cores, 2 * cores, 4 * cores}) {
+        bench<tsafe<int>>("std::mutex", threads);
+        bench<tsafe<int, adaptive_mutex>>("adaptive_mutex", threads);
+    }
+    return 0;
+}
@@ -1,10 +1,13 @@
 #include <future>
 #include <list>
 #include <shared_mutex>
+#include <thread>
+#include <algorithm>
 
 #define CATCH_CONFIG_MAIN
 #include <catch2/catch_all.hpp>
 
+#include "adaptive_mutex.hpp"
 #include "tsafe.hpp"
 
 using namespace qc;
@@ -91,11 +94,13 @@ using TSafeBasic = std::tuple<tsafe<T>,
                               shared_tsafe<T>,
                               shared_timed_tsafe<T>,
                               tsafe<T, my_mutex, my_unique_lock, my_shared_lock>,
+                              tsafe<T, adaptive_mutex>,
                               waitable_tsafe<T>,
                               timed_waitable_tsafe<T>,
                               shared_waitable_tsafe<T>,
                               shared_timed_waitable_tsafe<T>,
-                              waitable_tsafe<T, my_mutex, my_unique_lock, my_shared_lock>>;
+                              waitable_tsafe<T, my_mutex, my_unique_lock, my_shared_lock>,
+                              waitable_tsafe<T, adaptive_mutex>>;
 
 TEMPLATE_LIST_TEST_CASE("tsafe basic functions", "[tsafe][template]", TSafeBasic<int>)
 {
@@ -148,11 +153,13 @@ using TSafeUnique = std::tuple<unique_tsafe<T>,
                                shared_tsafe<T>,
                                shared_timed_tsafe<T>,
                                tsafe<T, my_mutex, my_unique_lock, my_shared_lock>,
+                               tsafe<T, adaptive_mutex>,
                                waitable_tsafe<T>,
                                timed_waitable_tsafe<T>,
                                shared_waitable_tsafe<T>,
                                shared_timed_waitable_tsafe<T>,
-                               waitable_tsafe<T, my_mutex, my_unique_lock, my_shared_lock>>;
+                               waitable_tsafe<T, my_mutex, my_unique_lock, my_shared_lock>,
+                               waitable_tsafe<T, adaptive_mutex>>;
 
 TEMPLATE_LIST_TEST_CASE("tsafe unique functions", "[unique_tsafe][template]", TSafeUnique<int>)
 {
@@ -288,7 +295,8 @@ using WaitableTSafe = std::tuple<waitable_tsafe<T>,
                                  timed_waitable_tsafe<T>,
                                  shared_waitable_tsafe<T>,
                                  shared_timed_waitable_tsafe<T>,
-                                 waitable_tsafe<T, my_mutex, my_unique_lock, my_shared_lock>>;
+                                 waitable_tsafe<T, my_mutex, my_unique_lock, my_shared_lock>,
+                                 waitable_tsafe<T, adaptive_mutex>>;
 
 TEMPLATE_LIST_TEST_CASE("waitable tsafe", "[waitable_tsafe][template]", WaitableTSafe<int>)
 {
@@ -340,3 +348,79 @@ TEMPLATE_LIST_TEST_CASE("waitable tsafe", "[waitable_tsafe][template]", Waitable
         REQUIRE(done_soon(std::move(future)));
     }
 }
+
+TEST_CASE("adaptive mutex under contention", "[adaptive_mutex]")
+{
+    tsafe<int, adaptive_mutex> safe{0};
+    const int thread_count = 2 * std::max(1u, std::thread::hardware_concurrency());
+
+    std::list<std::future<void>> futures;
+    for (int i = 0; i < thread_count; ++i) {
+        futures.emplace_back(std::async(std::launch::async, [&] {
+            for (int j = 0; j < 10000; ++j) {
+                safe.write([](auto& v) { ++v; });
+            }
+        }));
+    }
+    for (auto& f : futures) {
+        f.get();
+    }
+
+    REQUIRE(safe.get() == thread_count * 10000);
+}
+
+TEMPLATE_LIST_TEST_CASE("derived view", "[derived_view][template]", TSafeBasic<int>)
+{
+    TestType safe{12};
+    int computations = 0;
+    auto view = make_derived_view(safe, [&](const int& v) {
+        ++computations;
+        return v * 2;
+    });
+
+    REQUIRE(computations == 0);
+
+    SECTION("computed once until written")
+    {
+        REQUIRE(*view.get() == 24);
+        REQUIRE(*view.get() == 24);
+        REQUIRE(computations == 1);
+    }
+
+    SECTION("recomputed after a write")
+    {
+        REQUIRE(*view.get() == 24);
+        safe.set(21);
+        REQUIRE(*view.get() == 42);
+        REQUIRE(*view.get() == 42);
+        REQUIRE(computations == 2);
+    }
+
+    SECTION("recomputed after a write with a deferred lock")
+    {
+        safe.write_with_lock(
+            [&](auto& v, auto& lock) {
+                REQUIRE(*view.get() == 24);
+                lock.lock();
+                v = 21;
+            },
+            std::defer_lock);
+        REQUIRE(*view.get() == 42);
+    }
+
+    SECTION("not recomputed after a read")
+    {
+        REQUIRE(*view.get() == 24);
+        REQUIRE(safe.get() == 12);
+        REQUIRE(*view.get() == 24);
+        REQUIRE(computations == 1);
+    }
+
+    SECTION("shared by concurrent readers")
+    {
+        auto first = std::async(std::launch::async, [&] { return view.get(); });
+        auto second = std::async(std::launch::async, [&] { return view.get(); });
+        REQUIRE(first.get() == second.get());
+        REQUIRE(computations == 1);
+    }
+}
@@ -1,8 +1,12 @@
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
+#include <cstdint>
+#include <memory>
 #include <mutex>
 #include <shared_mutex>
+#include <type_traits>
 
 namespace qc {
 
@@ -42,9 +46,12 @@ template <typename CRTP,
 class basic_tsafe {
 private:
     mutable Mutex mutex_;
+    std::atomic<std::uint64_t> version_{0};
     T value_;
 
 public:
+    using value_type = T;
+
     template <typename... Args>
     basic_tsafe(Args&&... args) : value_{std::forward<Args>(args)...}
     {
@@ -54,6 +61,12 @@ public:
     auto write_with_lock(F&& fct, LArgs&&... largs)
     {
         Lock lock{mutex_, std::forward<LArgs>(largs)...};
+        // bump once the write is done: fct may unlock, or not hold the lock yet,
+        // and a read in between must not be taken for the written value.
+        // Every write pays for this atomic increment, usually uncontended
+        // as writers are serialized by the lock.
+        auto exit = details::call_on_exit(
+            [this]() { version_.fetch_add(1, std::memory_order_relaxed); });
         return fct(value_, lock);
     }
 
@@ -91,6 +104,9 @@ public:
     {
         return static_cast<const CRTP*>(this)->read([&](auto& value) { return value; });
     }
+
+    // Incremented by every write, when it finishes
+    std::uint64_t version() const { return version_.load(std::memory_order_relaxed); }
 };
 
 template <typename T,
@@ -218,4 +234,68 @@ template <typename T,
           typename ConditionVariable = details::best_cv_t<Lock, ConstLock>>
 using shared_timed_waitable_tsafe = waitable_tsafe<T, Mutex, Lock, ConstLock, ConditionVariable>;
 
+// Value computed from a tsafe, recomputed on read only when the tsafe was written.
+// Reading an up to date value takes no lock, concurrent readers of a stale
+// value wait for a single computation and share its result.
+// The computation runs under the read lock of the tsafe: with an exclusive mutex,
+// writers wait for it, use a shared mutex or keep the computation cheap.
+template <typename TSafe, typename F>
+class derived_view {
+public:
+    using value_type =
+        std::decay_t<std::invoke_result_t<F&, const typename TSafe::value_type&>>;
+
+    derived_view(const TSafe& safe, F fct) : safe_{safe}, fct_{std::move(fct)} {}
+
+    std::shared_ptr<const value_type> get() const
+    {
+        // cache hits only load the cached entry, readers never wait on each other
+        if (auto cached = load_if_current()) {
+            return cached;
+        }
+
+        std::lock_guard<std::mutex> lock{mutex_};
+        // another reader may have recomputed it while this one was waiting
+        if (auto cached = load_if_current()) {
+            return cached;
+        }
+
+        std::shared_ptr<const entry> computed;
+        safe_.read([&](const auto& value) {
+            // a write in progress has not bumped the version yet,
+            // so the value is recomputed once it finishes
+            computed = std::make_shared<const entry>(entry{safe_.version(), fct_(value)});
+        });
+        std::atomic_store(&cache_, computed);
+        return {computed, &computed->value};
+    }
+
+private:
+    struct entry {
+        std::uint64_t version;
+        value_type value;
+    };
+
+    std::shared_ptr<const value_type> load_if_current() const
+    {
+        auto cached = std::atomic_load(&cache_);
+        if (cached && cached->version == safe_.version()) {
+            return {cached, &cached->value};
+        }
+        return nullptr;
+    }
+
+    const TSafe& safe_;
+    mutable F fct_;
+    // serializes recomputations
+    mutable std::mutex mutex_;
+    mutable std::shared_ptr<const entry> cache_;
+};
+
+template <typename TSafe, typename F>
+derived_view<TSafe, std::decay_t<F>> make_derived_view(const TSafe& safe, F&& fct)
+{
+    return {safe, std::forward<F>(fct)};
+}
+
 } // namespace qc
@@ -0,0 +1,77 @@
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "parallel_zip.hpp"
+#include "zip.hpp"
+
+namespace {
+
+constexpr std::size_t size = 1 << 20;
+constexpr int repeat = 200;
+
+template <typename F>
+void bench(const std::string& name, std::vector<float>& out, F&& fct)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repeat; ++i) {
+        fct();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+
+    // read the output so the loops can't be optimized away
+    std::cout << name << ": " << us / repeat << "us per pass (" << out[size / 2] << ")"
+              << std::endl;
+}
+
+} // namespace
+
+int main(int, char**)
+{
+    using qctools::zip;
+    using qctools::zip_chunks;
+
+    std::vector<float> a(size, 1.5f);
+    std::vector<float> b(size, 2.0f);
+    std::vector<float> c(size, 0.5f);
+    std::vector<float> out(size);
+
+    bench("indexed", out, [&] {
+        for (std::size_t i = 0; i < size; ++i) {
+            out[i] = a[i] * b[i] + c[i];
+        }
+    });
+
+    bench("zip", out, [&] {
+        for (auto&& t : zip(a, b, c, out)) {
+            std::get<3>(t) = std::get<0>(t) * std::get<1>(t) + std::get<2>(t);
+        }
+    });
+
+    bench("zip_chunks", out, [&] {
+        auto fma = [](auto chunk) {
+            auto pa = std::get<0>(chunk);
+            auto pb = std::get<1>(chunk);
+            auto pc = std::get<2>(chunk);
+            auto pout = std::get<3>(chunk);
+            for (std::size_t i = 0; i < chunk.size(); ++i) {
+                pout[i] = pa[i] * pb[i] + pc[i];
+            }
+        };
+        auto chunks = zip_chunks<64>(a, b, c, out);
+        for (auto chunk : chunks) {
+            fma(chunk);
+        }
+        fma(chunks.tail());
+    });
+
+    bench("zip_transform", out, [&] {
+        qctools::zip_transform(
+            out, [](float a, float b, float c) { return a * b + c; }, a, b, c);
+    });
+
+    return 0;
+}
@@ -1,9 +1,40 @@
 #include <iostream>
+#include <iterator>
+#include <sstream>
 #include <string>
 #include <vector>
 
+#include "parallel_zip.hpp"
 #include "zip.hpp"
 
+namespace {
+
+// Generates 0, 1, 2... up to a sentinel, operator* returns by value
+struct counter {
+    struct sentinel {
+        int last;
+    };
+
+    struct iterator {
+        int operator*() const { return value; }
+        iterator& operator++()
+        {
+            ++value;
+            return *this;
+        }
+        bool operator==(const sentinel& end) const { return value == end.last; }
+
+        int value;
+    };
+
+    iterator begin() const { return {0}; }
+    sentinel end() const { return {last}; }
+
+    int last;
+};
+
+} // namespace
+
 int main(int, char**)
 {
     using qctools::zip;
@@ -26,5 +57,50 @@ int main(int, char**)
     for (const auto& pair : zip(cv1, cv2)) {
         std::cerr << std::get<0>(pair) << ", " << std::get<1>(pair) << std::endl;
     }
+
+    // chunks
+    std::vector<float> x = {1, 2, 3, 4, 5, 6, 7};
+    std::vector<float> y = {7, 6, 5, 4, 3, 2, 1};
+    std::vector<float> out(x.size());
+    auto add = [](auto chunk) {
+        for (std::size_t i = 0; i < chunk.size(); ++i) {
+            std::get<2>(chunk)[i] = std::get<0>(chunk)[i] + std::get<1>(chunk)[i];
+        }
+    };
+    auto chunks = qctools::zip_chunks<4>(x, y, out);
+    for (auto chunk : chunks) {
+        add(chunk);
+    }
+    add(chunks.tail());
+    for (const auto& v : out) {
+        std::cerr << v << std::endl;
+    }
+
+    // stream
+    std::istringstream numbers{"1 2 3 4"};
+    std::istringstream words{"a b c"};
+    auto numbers_range = qctools::make_range(std::istream_iterator<int>{numbers},
+                                             std::istream_iterator<int>{});
+    auto words_range = qctools::make_range(std::istream_iterator<std::string>{words},
+                                           std::istream_iterator<std::string>{});
+    for (const auto& pair : qctools::zip_stream(numbers_range, words_range, v1)) {
+        std::cerr << std::get<0>(pair) << ", " << std::get<1>(pair) << ", " << std::get<2>(pair)
+                  << std::endl;
+    }
+
+    // generated values
+    for (const auto& pair : qctools::zip_stream(counter{5}, v2)) {
+        std::cerr << std::get<0>(pair) << ", " << std::get<1>(pair) << std::endl;
+    }
+
+    // parallel
+    qctools::zip_executor executor{4, 2};
+    executor.transform(out, [](float a, float b) { return a * b; }, x, y);
+    auto sum = executor.reduce(
+        0.f, [](float a, float b) { return a + b; }, [](float o) { return o; }, out);
+    std::cerr << sum << std::endl;
+    auto any_large = executor.reduce(
+        false, [](bool a, bool b) { return a || b; }, [](float o) { return o > 15; }, out);
+    std::cerr << std::boolalpha << any_large << std::endl;
     return 0;
 }
@@ -0,0 +1,230 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <algorithm>
+
+#include "zip.hpp"
+
+namespace qctools {
+namespace details {
+
+template <typename F, typename Tuple, std::size_t... I>
+decltype(auto) apply_impl(F&& fct, Tuple&& tup, std::index_sequence<I...>)
+{
+    return std::forward<F>(fct)(std::get<I>(std::forward<Tuple>(tup))...);
+}
+
+template <typename F, typename Tuple>
+decltype(auto) apply(F&& fct, Tuple&& tup)
+{
+    return apply_impl(std::forward<F>(fct),
+                      std::forward<Tuple>(tup),
+                      std::make_index_sequence<std::tuple_size<std::decay_t<Tuple>>::value>{});
+}
+
+template <typename... C>
+constexpr std::size_t row_size()
+{
+    std::size_t size = 0;
+    for (std::size_t s : {sizeof(std::decay_t<decltype(*std::declval<C&>().begin())>)...}) {
+        size += s;
+    }
+    return size;
+}
+
+template <typename... C>
+constexpr bool is_random_access = logic_and<std::is_base_of<
+    std::random_access_iterator_tag,
+    typename std::iterator_traits<
+        decltype(std::declval<C&>().begin())>::iterator_category>::value...>::value;
+
+// Chunk results are written concurrently: no std::vector<bool> packing
+template <typename T>
+struct slot {
+    T value;
+};
+
+// Joins the threads still running when leaving the scope
+struct joining_threads {
+    std::vector<std::thread> threads;
+
+    ~joining_threads()
+    {
+        for (auto& thread : threads) {
+            if (thread.joinable()) {
+                thread.join();
+            }
+        }
+    }
+};
+
+} // namespace details
+
+// Runs element-wise loops over zipped random access containers on several threads.
+// The common length is split in chunks of consecutive rows, threads claim
+// chunks dynamically so that a slow thread does not delay the others.
+// Chunk boundaries only depend on the chunk size, never on the thread count.
+class zip_executor {
+public:
+    // Bytes of rows processed by a chunk when no chunk size is given
+    static constexpr std::size_t default_chunk_bytes = 256 * 1024;
+
+    // 0 threads uses std::thread::hardware_concurrency(),
+    // a chunk size of 0 derives the chunk size from default_chunk_bytes.
+    explicit zip_executor(std::size_t thread_count = 0, std::size_t chunk_size = 0)
+        : thread_count_{thread_count ? thread_count
+                                     : std::max(1u, std::thread::hardware_concurrency())},
+          chunk_size_{chunk_size}
+    {
+    }
+
+    // Calls fct(elements...) for each row
+    template <typename F, typename... Containers>
+    void for_each(F&& fct, Containers&&... containers) const
+    {
+        static_assert(details::is_random_access<Containers...>,
+                      "chunks start at random positions, containers must be random access");
+        auto zipped = zip(std::forward<Containers>(containers)...);
+        run(zipped.size(),
+            chunk_size<Containers...>(),
+            [&](std::size_t, std::size_t first, std::size_t last) {
+                auto it = zipped.begin();
+                it += static_cast<std::ptrdiff_t>(first);
+                for (auto i = first; i < last; ++i, ++it) {
+                    details::apply(fct, *it);
+                }
+            });
+    }
+
+    // Assigns fct(inputs...) to each element of out
+    template <typename Out, typename F, typename... Inputs>
+    void transform(Out&& out, F&& fct, Inputs&&... inputs) const
+    {
+        for_each([&](auto& o, auto&&... in) { o = fct(std::forward<decltype(in)>(in)...); },
+                 std::forward<Out>(out),
+                 std::forward<Inputs>(inputs)...);
+    }
+
+    // Folds map(elements...) over all rows with combine, starting from init.
+    // Each chunk is folded in order, then chunk results are folded in order:
+    // the result is the same whatever the number of threads.
+    template <typename T, typename Reduce, typename Map, typename... Containers>
+    T reduce(T init, Reduce&& combine, Map&& map, Containers&&... containers) const
+    {
+        static_assert(details::is_random_access<Containers...>,
+                      "chunks start at random positions, containers must be random access");
+        auto zipped = zip(std::forward<Containers>(containers)...);
+        auto size = zipped.size();
+        auto chunk = chunk_size<Containers...>();
+        std::vector<details::slot<T>> partials((size + chunk - 1) / chunk, {init});
+
+        run(size, chunk, [&](std::size_t index, std::size_t first, std::size_t last) {
+            auto it = zipped.begin();
+            it += static_cast<std::ptrdiff_t>(first);
+            T partial = details::apply(map, *it);
+            for (auto i = first + 1; i < last; ++i) {
+                ++it;
+                partial = combine(std::move(partial), details::apply(map, *it));
+            }
+            partials[index].value = std::move(partial);
+        });
+
+        for (auto& partial : partials) {
+            init = combine(std::move(init), std::move(partial.value));
+        }
+        return init;
+    }
+
+private:
+    template <typename... Containers>
+    std::size_t chunk_size() const
+    {
+        if (chunk_size_) {
+            return chunk_size_;
+        }
+        return std::max<std::size_t>(1, default_chunk_bytes / details::row_size<Containers...>());
+    }
+
+    // Calls fct(index, first, last) for each chunk
+    template <typename F>
+    void run(std::size_t size, std::size_t chunk, F&& fct) const
+    {
+        const std::size_t chunk_count = (size + chunk - 1) / chunk;
+        std::atomic<std::size_t> next{0};
+        std::atomic<bool> failed{false};
+        std::exception_ptr error;
+        std::mutex error_mutex;
+
+        auto worker = [&] {
+            try {
+                for (auto index = next++; index < chunk_count && !failed; index = next++) {
+                    fct(index, index * chunk, std::min(size, (index + 1) * chunk));
+                }
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock{error_mutex};
+                if (!error) {
+                    error = std::current_exception();
+                }
+                failed = true;
+            }
+        };
+
+        {
+            // workers reference this frame, they are joined even if a thread can't start
+            details::joining_threads workers;
+            try {
+                for (std::size_t i = 1; i < std::min(thread_count_, chunk_count); ++i) {
+                    workers.threads.emplace_back(worker);
+                }
+            }
+            catch (...) {
+                failed = true;
+                throw;
+            }
+
+            // the calling thread is one of the workers
+            worker();
+        }
+
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    std::size_t thread_count_;
+    std::size_t chunk_size_;
+};
+
+template <typename F, typename... Containers>
+void zip_for_each(F&& fct, Containers&&... containers)
+{
+    zip_executor{}.for_each(std::forward<F>(fct), std::forward<Containers>(containers)...);
+}
+
+template <typename Out, typename F, typename... Inputs>
+void zip_transform(Out&& out, F&& fct, Inputs&&... inputs)
+{
+    zip_executor{}.transform(
+        std::forward<Out>(out), std::forward<F>(fct), std::forward<Inputs>(inputs)...);
+}
+
+template <typename T, typename Reduce, typename Map, typename... Containers>
+T zip_reduce(T init, Reduce&& reduce, Map&& map, Containers&&... containers)
+{
+    return zip_executor{}.reduce(std::move(init),
+                                 std::forward<Reduce>(reduce),
+                                 std::forward<Map>(map),
+                                 std::forward<Containers>(containers)...);
+}
+
+} // namespace qctools
@@ -1,6 +1,10 @@
 #pragma once
 
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
 #include <tuple>
+#include <type_traits>
 #include <utility>
 #include <algorithm>
 
@@ -19,6 +23,11 @@ struct logic_and<B> {
     static constexpr bool value = B;
 };
 
+template <typename T>
+auto min(T v)
+{
+    return v;
+}
 template <typename T0, typename T1>
 auto min(T0 v0, T1 v1)
 {
@@ -47,6 +56,7 @@ public:
 
         auto operator*() { return deref_impl(seq{}); }
         iterator_impl& operator++() { return inc_impl(seq{}); }
+        iterator_impl& operator+=(std::ptrdiff_t n) { return advance_impl(n, seq{}); }
         bool operator==(const iterator_impl& other) const { return iterators == other.iterators; }
         bool operator!=(const iterator_impl& other) const { return iterators != other.iterators; }
 
@@ -58,6 +68,13 @@ public:
             return *this;
         }
 
+        template <std::size_t... I>
+        iterator_impl& advance_impl(std::ptrdiff_t n, std::index_sequence<I...>)
+        {
+            do_nothing((std::advance(std::get<I>(iterators), n), 0)...);
+            return *this;
+        }
+
         template <std::size_t... I>
         auto deref_impl(std::index_sequence<I...>)
         {
@@ -74,6 +91,7 @@ public:
 
     auto begin() { return begin_impl(seq{}); }
     auto end() { return end_impl(seq{}); }
+    std::size_t size() { return size_impl(seq{}); }
 
 private:
     template <std::size_t... I>
@@ -86,20 +104,222 @@ private:
     template <std::size_t... I>
     auto end_impl(std::index_sequence<I...>)
     {
-        auto distance =
-            min(std::distance(std::get<I>(containers).begin(), std::get<I>(containers).end())...);
+        auto distance = size_impl(std::index_sequence<I...>{});
         return std::conditional_t<is_const, const_iterator, iterator>{
             std::make_tuple(std::next(std::get<I>(containers).begin(), distance)...)};
     }
 
+    template <std::size_t... I>
+    std::size_t size_impl(std::index_sequence<I...>)
+    {
+        return min(static_cast<std::size_t>(std::distance(std::get<I>(containers).begin(),
+                                                          std::get<I>(containers).end()))...);
+    }
+
     std::tuple<C&&...> containers;
 };
 
+template <typename C>
+using data_t = std::remove_pointer_t<decltype(std::declval<C&>().data())>;
+
+// A block of elements: one pointer per container, all valid for size() elements.
+// Size is either std::integral_constant (full blocks) or std::size_t (tail).
+template <typename Size, typename... Ts>
+class chunk : public std::tuple<Ts*...> {
+public:
+    chunk(std::tuple<Ts*...> pointers, Size size) : std::tuple<Ts*...>(pointers), size_(size) {}
+
+    constexpr Size size() const { return size_; }
+
+private:
+    Size size_;
+};
+
+template <std::size_t Width, typename... C>
+class zip_chunks_impl {
+    static_assert(Width > 0, "chunk width must be strictly positive");
+
+    using seq = std::make_index_sequence<sizeof...(C)>;
+
+public:
+    using full_chunk = chunk<std::integral_constant<std::size_t, Width>, data_t<C>...>;
+    using tail_chunk = chunk<std::size_t, data_t<C>...>;
+
+    class iterator {
+    public:
+        iterator(std::tuple<data_t<C>*...> pointers, std::size_t index)
+            : pointers(pointers), index(index)
+        {
+        }
+
+        full_chunk operator*() const { return {offset_impl(seq{}), {}}; }
+        iterator& operator++()
+        {
+            index += Width;
+            return *this;
+        }
+        bool operator==(const iterator& other) const { return index == other.index; }
+        bool operator!=(const iterator& other) const { return index != other.index; }
+
+    private:
+        template <std::size_t... I>
+        std::tuple<data_t<C>*...> offset_impl(std::index_sequence<I...>) const
+        {
+            return std::tuple<data_t<C>*...>{(std::get<I>(pointers) + index)...};
+        }
+
+        std::tuple<data_t<C>*...> pointers;
+        std::size_t index;
+    };
+
+    explicit zip_chunks_impl(C&&... containers)
+        : pointers(containers.data()...), size(min(containers.size()...))
+    {
+    }
+
+    iterator begin() const { return {pointers, 0}; }
+    iterator end() const { return {pointers, size - size % Width}; }
+
+    // Remaining elements that do not fill a whole chunk, possibly empty
+    tail_chunk tail() const { return {tail_impl(seq{}), size % Width}; }
+
+private:
+    template <std::size_t... I>
+    std::tuple<data_t<C>*...> tail_impl(std::index_sequence<I...>) const
+    {
+        return std::tuple<data_t<C>*...>{(std::get<I>(pointers) + (size - size % Width))...};
+    }
+
+    std::tuple<data_t<C>*...> pointers;
+    std::size_t size;
+};
+
+template <typename C>
+using begin_t = decltype(std::declval<C&>().begin());
+
+template <typename C>
+using end_t = decltype(std::declval<C&>().end());
+
+template <typename... C>
+class zip_stream_impl {
+    using seq = std::make_index_sequence<sizeof...(C)>;
+
+public:
+    // Single pass iterator, all copies share the state of the zip_stream_impl
+    class iterator {
+    public:
+        explicit iterator(zip_stream_impl* parent) : parent(parent) {}
+
+        auto operator*() const { return parent->deref_impl(seq{}); }
+        iterator& operator++()
+        {
+            parent->inc_impl(seq{});
+            return *this;
+        }
+        bool operator==(const iterator& other) const { return done() == other.done(); }
+        bool operator!=(const iterator& other) const { return done() != other.done(); }
+
+    private:
+        bool done() const { return parent == nullptr || parent->done_impl(seq{}); }
+
+        zip_stream_impl* parent;
+    };
+
+    explicit zip_stream_impl(C&&... ranges)
+        : iterators(ranges.begin()...), sentinels(ranges.end()...)
+    {
+    }
+
+    iterator begin() { return iterator{this}; }
+    iterator end() { return iterator{nullptr}; }
+
+private:
+    // References are kept as references, values returned by operator* are stored
+    template <std::size_t... I>
+    auto deref_impl(std::index_sequence<I...>)
+    {
+        return std::tuple<decltype(*std::get<I>(iterators))...>{(*std::get<I>(iterators))...};
+    }
+
+    // Ranges are advanced in order and the ones after an exhausted range are left
+    // untouched, ranges listed before it have already moved past the last row.
+    template <std::size_t... I>
+    void inc_impl(std::index_sequence<I...>)
+    {
+        bool exhausted = false;
+        auto advance = [&](auto& it, const auto& sentinel) {
+            if (!exhausted) {
+                ++it;
+                exhausted = it == sentinel;
+            }
+            return exhausted;
+        };
+        // braced lists are evaluated from left to right
+        for (bool done : {advance(std::get<I>(iterators), std::get<I>(sentinels))...}) {
+            (void)done;
+        }
+    }
+
+    template <std::size_t... I>
+    bool done_impl(std::index_sequence<I...>) const
+    {
+        for (bool exhausted : {(std::get<I>(iterators) == std::get<I>(sentinels))...}) {
+            if (exhausted) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::tuple<begin_t<C>...> iterators;
+    std::tuple<end_t<C>...> sentinels;
+};
+
 } // namespace details
 
+template <typename Iterator, typename Sentinel = Iterator>
+class iterator_range {
+public:
+    iterator_range(Iterator first, Sentinel last) : first(first), last(last) {}
+
+    Iterator begin() const { return first; }
+    Sentinel end() const { return last; }
+
+private:
+    Iterator first;
+    Sentinel last;
+};
+
+template <typename Iterator, typename Sentinel>
+iterator_range<Iterator, Sentinel> make_range(Iterator first, Sentinel last)
+{
+    return {first, last};
+}
+
 template <class... Containers>
 auto zip(Containers&&... containers)
 {
     return details::zip_impl<Containers&&...>{std::forward<Containers>(containers)...};
 }
+
+// Zip contiguous containers (anything with data() and size()) by blocks of Width elements.
+// Each chunk exposes one pointer per container through std::get, so inner loops
+// bounded by chunk.size() have a compile-time trip count and can be vectorized.
+// The last incomplete block is not iterated, it is returned by tail().
+template <std::size_t Width, class... Containers>
+auto zip_chunks(Containers&&... containers)
+{
+    return details::zip_chunks_impl<Width, Containers&&...>{
+        std::forward<Containers>(containers)...};
+}
+
+// Zip ranges in a single pass: works with input iterators and with ranges whose
+// end() is a sentinel of a different type. Lengths are never computed, iteration
+// stops as soon as any of the ranges is exhausted: put the input streams that
+// must not be read past the last row after the shortest range.
+template <class... Ranges>
+auto zip_stream(Ranges&&... ranges)
+{
+    return details::zip_stream_impl<Ranges&&...>{std::forward<Ranges>(ranges)...};
+}
 } // namespace qctools